@@ -126,6 +126,59 @@ std::optional<std::tuple<int, int, int, int, int, int, int, int, int, double, in
     return std::nullopt;
 }
 
+// Fetches rows inserted after the given rowid (high-water mark) in one query
+std::optional<std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>>> DatabaseOperations::fetch_rows_since(sqlite3_int64& last_rowid) {
+    if (!db || !*db) {
+        std::cerr << "Error: Database is not open." << std::endl;
+        return std::nullopt;
+    }
+
+    sqlite3_stmt* stmt;
+    std::string query = "SELECT rowid, * FROM tablica WHERE rowid > ? ORDER BY rowid";
+
+    int rc = sqlite3_prepare_v2(*db, query.c_str(), -1, &stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        std::cerr << "Error: Unable to prepare SQL query: " << sqlite3_errmsg(*db) << std::endl;
+        return std::nullopt;
+    }
+    sqlite3_bind_int64(stmt, 1, last_rowid);
+
+    // Column 0 is the rowid, the table columns start at index 1
+    std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>> rows;
+    sqlite3_int64 max_rowid = last_rowid;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int> row;
+
+        std::get<0>(row) = sqlite3_column_int(stmt, 1);
+        std::get<1>(row) = sqlite3_column_int(stmt, 2);
+        std::get<2>(row) = sqlite3_column_int(stmt, 3);
+        std::get<3>(row) = sqlite3_column_int(stmt, 4);
+        std::get<4>(row) = sqlite3_column_int(stmt, 5);
+        std::get<5>(row) = sqlite3_column_int(stmt, 6);
+        std::get<6>(row) = sqlite3_column_int(stmt, 7);
+        std::get<7>(row) = sqlite3_column_int(stmt, 8);
+        std::get<8>(row) = sqlite3_column_int(stmt, 9);
+        std::get<9>(row) = sqlite3_column_double(stmt, 10);  // double value
+        std::get<10>(row) = sqlite3_column_int(stmt, 11);
+        std::get<11>(row) = sqlite3_column_int(stmt, 12);
+        std::get<12>(row) = sqlite3_column_int(stmt, 13);
+        std::get<13>(row) = sqlite3_column_int(stmt, 14);
+
+        rows.push_back(row);
+        max_rowid = sqlite3_column_int64(stmt, 0);
+    }
+
+    if (rc != SQLITE_DONE) {
+        std::cerr << "Error fetching rows after rowid: " << last_rowid << " | Error: " << sqlite3_errmsg(*db) << std::endl;
+        sqlite3_finalize(stmt);
+        return std::nullopt;
+    }
+
+    sqlite3_finalize(stmt);
+    last_rowid = max_rowid;
+    return rows;
+}
+
 // Destructor to close the database
 DatabaseOperations::~DatabaseOperations() {
     close_database();
@@ -4,14 +4,17 @@
 #include <algorithm>  // std::random_shuffle
 #include <ctime>      // std::time
 #include <random>     // std::default_random_engine
+#include <fstream>
+#include <iomanip>    // std::setprecision
+#include <filesystem> // std::filesystem::exists
 
-LogisticRegression::LogisticRegression(double alpha, int iterations)
-    : alpha(alpha), iterations(iterations) {
+LogisticRegression::LogisticRegression(double alpha, int iterations, SigmoidKernels::KernelMode kernel_mode)
+    : alpha(alpha), iterations(iterations), last_rowid(0), kernel_mode(kernel_mode) {
     theta.resize(13, 0.0);  // Number of coefficients (features + bias)
 }
 
 double LogisticRegression::sigmoid(double z) {
-    return 1.0 / (1.0 + exp(-z));
+    return SigmoidKernels::sigmoid(z, kernel_mode);
 }
 
 double LogisticRegression::computeCostSingle(const std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>& row) {
@@ -29,9 +32,9 @@ double LogisticRegression::computeCostSingle(const std::tuple<int, int, int, int
     z += std::get<11>(row) * theta[11];
     z += std::get<12>(row) * theta[12];
 
-    double h = sigmoid(z);
+    // Loss computed from the logit, stays finite for large |z|
     double y = std::get<13>(row);
-    return -y * log(h) - (1 - y) * log(1 - h);
+    return SigmoidKernels::logLossFromLogit(z, y, kernel_mode);
 }
 
 void LogisticRegression::gradientDescentStep(const std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>& row) {
@@ -68,6 +71,42 @@ void LogisticRegression::gradientDescentStep(const std::tuple<int, int, int, int
     theta[12] -= alpha * error * std::get<12>(row);
 }
 
+// Counts wrong predictions; logits are computed first and passed through the sigmoid in one batch
+int LogisticRegression::calculateErrors(const std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>>& test_data) {
+    std::vector<double> z_values;
+    z_values.reserve(test_data.size());
+    for (const auto& row : test_data) {
+        double z = theta[0];
+        z += std::get<0>(row) * theta[1];
+        z += std::get<1>(row) * theta[2];
+        z += std::get<2>(row) * theta[3];
+        z += std::get<3>(row) * theta[4];
+        z += std::get<4>(row) * theta[5];
+        z += std::get<5>(row) * theta[6];
+        z += std::get<6>(row) * theta[7];
+        z += std::get<7>(row) * theta[8];
+        z += std::get<8>(row) * theta[9];
+        z += std::get<10>(row) * theta[10];
+        z += std::get<11>(row) * theta[11];
+        z += std::get<12>(row) * theta[12];
+        z_values.push_back(z);
+    }
+
+    std::vector<double> h_values(z_values.size());
+    SigmoidKernels::sigmoidBatch(z_values.data(), h_values.data(), z_values.size(), kernel_mode);
+
+    int errors = 0;
+    for (size_t i = 0; i < test_data.size(); ++i) {
+        int prediction = h_values[i] >= 0.5 ? 1 : 0;
+        int actual = std::get<13>(test_data[i]);
+
+        if (prediction != actual) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
 void LogisticRegression::crossValidation(DatabaseOperations& db_ops, int k_folds) {
     std::vector<double> accuracy;
     std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>> all_rows;
@@ -99,32 +138,8 @@ void LogisticRegression::crossValidation(DatabaseOperations& db_ops, int k_folds
             }
         }
 
-        int correct_predictions = 0;
-        int total_predictions = 0;
-        for (const auto& row : test_data) {
-            double z = theta[0];
-            z += std::get<0>(row) * theta[1];
-            z += std::get<1>(row) * theta[2];
-            z += std::get<2>(row) * theta[3];
-            z += std::get<3>(row) * theta[4];
-            z += std::get<4>(row) * theta[5];
-            z += std::get<5>(row) * theta[6];
-            z += std::get<6>(row) * theta[7];
-            z += std::get<7>(row) * theta[8];
-            z += std::get<8>(row) * theta[9];
-            z += std::get<10>(row) * theta[10];
-            z += std::get<11>(row) * theta[11];
-            z += std::get<12>(row) * theta[12];
-
-            double h = sigmoid(z);
-            int prediction = h >= 0.5 ? 1 : 0;
-            int actual = std::get<13>(row);
-
-            if (prediction == actual) {
-                correct_predictions++;
-            }
-            total_predictions++;
-        }
+        int total_predictions = test_data.size();
+        int correct_predictions = total_predictions - calculateErrors(test_data);
         accuracy.push_back(static_cast<double>(correct_predictions) / total_predictions);
         std::cout << "Accuracy for fold " << (fold + 1) << ": " << accuracy.back() << std::endl;
     }
@@ -136,19 +151,21 @@ void LogisticRegression::crossValidation(DatabaseOperations& db_ops, int k_folds
     std::cout << "Mean accuracy for validation: " << mean_accuracy << "\n" << std::endl;
 }
 
-void LogisticRegression::trainModel(DatabaseOperations& db_train, DatabaseOperations& db_test) {
+bool LogisticRegression::trainModel(DatabaseOperations& db_train, DatabaseOperations& db_test) {
     std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>> train_data, test_data;
     
-    int row_number_train = 0;
-    auto row = db_train.fetch_row(row_number_train);
-    while (row.has_value()) {
-        train_data.push_back(row.value());
-        row_number_train++;
-        row = db_train.fetch_row(row_number_train);
+    // All training rows are fetched in one query, which also sets the high-water mark for incremental training
+    last_rowid = 0;
+    auto rows = db_train.fetch_rows_since(last_rowid);
+    if (!rows.has_value()) {
+        Logger logger("Failed to fetch the training data");
+        std::cerr << "Error: Unable to fetch the training data." << std::endl;
+        return false;
     }
+    train_data = std::move(rows.value());
 
     int row_number_test = 0;
-    row = db_test.fetch_row(row_number_test);
+    auto row = db_test.fetch_row(row_number_test);
     while (row.has_value()) {
         test_data.push_back(row.value());
         row_number_test++;
@@ -161,32 +178,119 @@ void LogisticRegression::trainModel(DatabaseOperations& db_train, DatabaseOperat
         }
     }
 
-    int correct_predictions = 0;
-    int total_predictions = 0;
-    for (const auto& row : test_data) {
-        double z = theta[0];
-        z += std::get<0>(row) * theta[1];
-        z += std::get<1>(row) * theta[2];
-        z += std::get<2>(row) * theta[3];
-        z += std::get<3>(row) * theta[4];
-        z += std::get<4>(row) * theta[5];
-        z += std::get<5>(row) * theta[6];
-        z += std::get<6>(row) * theta[7];
-        z += std::get<7>(row) * theta[8];
-        z += std::get<8>(row) * theta[9];
-        z += std::get<10>(row) * theta[10];
-        z += std::get<11>(row) * theta[11];
-        z += std::get<12>(row) * theta[12];
+    int total_predictions = test_data.size();
+    int correct_predictions = total_predictions - calculateErrors(test_data);
+    double accuracy = static_cast<double>(correct_predictions) / total_predictions;
+    std::cout << "Model accuracy: " << accuracy << std::endl;
+    return true;
+}
 
-        double h = sigmoid(z);
-        int prediction = h >= 0.5 ? 1 : 0;
-        int actual = std::get<13>(row);
+bool LogisticRegression::trainIncremental(DatabaseOperations& db_train, const std::string& model_path, int epochs) {
+    // The first model comes from trainModel; a missing or corrupt one is never replaced here
+    if (!std::filesystem::exists(model_path)) {
+        std::string mess = "No saved model found at " + model_path + ", run full training first";
+        Logger logger(mess);
+        std::cerr << "Error: " << mess << std::endl;
+        return false;
+    }
+    if (!loadModel(model_path)) {
+        std::cerr << "Error: Incremental training aborted, the model in " << model_path << " was not changed." << std::endl;
+        return false;
+    }
+
+    // Only rows inserted after the high-water mark are fetched
+    sqlite3_int64 previous_rowid = last_rowid;
+    auto fetched_rows = db_train.fetch_rows_since(last_rowid);
+    if (!fetched_rows.has_value()) {
+        std::string mess = "Failed to fetch rows after rowid " + std::to_string(previous_rowid) + ", model unchanged";
+        Logger logger(mess);
+        std::cerr << "Error: " << mess << std::endl;
+        return false;
+    }
 
-        if (prediction == actual) {
-            correct_predictions++;
+    const auto& new_rows = fetched_rows.value();
+    if (new_rows.empty()) {
+        std::cout << "No new rows since rowid " << previous_rowid << ", model unchanged." << std::endl;
+        return true;
+    }
+
+    // Continue gradient descent from the saved weights
+    for (int epoch = 0; epoch < epochs; ++epoch) {
+        for (const auto& row : new_rows) {
+            gradientDescentStep(row);
         }
-        total_predictions++;
     }
-    double accuracy = static_cast<double>(correct_predictions) / total_predictions;
-    std::cout << "Model accuracy: " << accuracy << std::endl;
+
+    if (!saveModel(model_path)) {
+        return false;
+    }
+    std::cout << "Incremental training on " << new_rows.size() << " new rows done (last rowid: " << last_rowid << ")." << std::endl;
+    return true;
+}
+
+// Saves the model as: last rowid on the first line, then the coefficients.
+// The model is written to a temporary file first, so a failed save never leaves a truncated model behind
+bool LogisticRegression::saveModel(const std::string& model_path) const {
+    std::string tmp_path = model_path + ".tmp";
+    std::ofstream file(tmp_path, std::ios_base::trunc);
+    if (file.is_open()) {
+        file << last_rowid << "\n";
+        file << std::setprecision(17);
+        for (double coefficient : theta) {
+            file << coefficient << "\n";
+        }
+        file.close();  // Flushes the data, write errors show up in the stream state
+    }
+
+    std::error_code ec;
+    if (!file.fail()) {
+        std::filesystem::rename(tmp_path, model_path, ec);
+    }
+
+    if (file.fail() || ec) {
+        std::filesystem::remove(tmp_path, ec);
+        std::string mess = "Failed to save the model to: " + model_path;
+        Logger logger(mess);
+        std::cerr << "Error: " << mess << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Loads the model saved by saveModel; the current state is kept if the file cannot be read or is malformed
+bool LogisticRegression::loadModel(const std::string& model_path) {
+    std::ifstream file(model_path);
+    if (!file.is_open()) {
+        std::string mess = "Failed to open the model file: " + model_path;
+        Logger logger(mess);
+        std::cerr << "Error: " << mess << std::endl;
+        return false;
+    }
+
+    sqlite3_int64 loaded_rowid;
+    std::vector<double> loaded_theta(theta.size());
+    file >> loaded_rowid;
+    for (double& coefficient : loaded_theta) {
+        file >> coefficient;
+    }
+    file >> std::ws;  // Only whitespace may follow the coefficients
+
+    if (file.fail() || !file.eof()) {
+        std::string mess = "Malformed model file: " + model_path;
+        Logger logger(mess);
+        std::cerr << "Error: " << mess << std::endl;
+        return false;
+    }
+
+    last_rowid = loaded_rowid;
+    theta = std::move(loaded_theta);
+    return true;
+}
+
+const std::vector<double>& LogisticRegression::getTheta() const {
+    return theta;
+}
+
+sqlite3_int64 LogisticRegression::getLastRowId() const {
+    return last_rowid;
 }
@@ -0,0 +1,154 @@
+#include "SigmoidKernels.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>    // std::memcpy
+#include <algorithm>  // std::min, std::max
+
+namespace SigmoidKernels {
+
+namespace {
+
+const double LOG2E = 1.4426950408889634;
+const double LN2_HI = 6.93147180369123816490e-01;  // ln(2) split in two parts for exact range reduction
+const double LN2_LO = 1.90821492927058770002e-10;
+const double ROUND_MAGIC = 6755399441055744.0;     // 1.5 * 2^52, rounds to nearest integer when added
+
+// Bit manipulation is done on unsigned integers, where wrap-around and shifts are always defined
+inline std::uint64_t toBits(double x) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+inline double fromBits(std::uint64_t bits) {
+    double x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+// exp(x) = 2^k * exp(r) with |r| <= ln(2)/2, exp(r) from a degree 11 Taylor polynomial
+inline double fastExpKernel(double x) {
+    x = x < -708.0 ? -708.0 : x;
+    x = x > 709.0 ? 709.0 : x;
+
+    // k = round(x / ln(2)), the integer part is read from the low bits of t (modulo 2^64 for negative k).
+    // A NaN input is not clamped, it gives a meaningless k but propagates through r and p
+    double t = x * LOG2E + ROUND_MAGIC;
+    std::uint64_t k = toBits(t) - toBits(ROUND_MAGIC);
+    double kd = t - ROUND_MAGIC;
+    double r = (x - kd * LN2_HI) - kd * LN2_LO;
+
+    double p = 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    // 2^k built directly in the exponent field
+    return p * fromBits((k + 1023) << 52);
+}
+
+// log(1 + u) = 2 * atanh(s) with s = u / (2 + u) in [0, 1/3] for u in [0, 1]
+inline double fastLog1pKernel(double u) {
+    double s = u / (2.0 + u);
+    double s2 = s * s;
+
+    double p = 1.0 / 21.0;
+    p = p * s2 + 1.0 / 19.0;
+    p = p * s2 + 1.0 / 17.0;
+    p = p * s2 + 1.0 / 15.0;
+    p = p * s2 + 1.0 / 13.0;
+    p = p * s2 + 1.0 / 11.0;
+    p = p * s2 + 1.0 / 9.0;
+    p = p * s2 + 1.0 / 7.0;
+    p = p * s2 + 1.0 / 5.0;
+    p = p * s2 + 1.0 / 3.0;
+    p = p * s2 + 1.0;
+
+    return 2.0 * s * p;
+}
+
+// Both branches only evaluate exp of a non-positive argument, so nothing overflows
+inline double softplusExact(double x) {
+    return (x > 0.0 ? x : 0.0) + std::log1p(std::exp(-std::fabs(x)));
+}
+
+inline double softplusFast(double x) {
+    return (x > 0.0 ? x : 0.0) + fastLog1pKernel(fastExpKernel(-std::fabs(x)));
+}
+
+inline double sigmoidExact(double z) {
+    double e = std::exp(-std::fabs(z));
+    double s = 1.0 / (1.0 + e);
+    double es = e * s;
+    return z >= 0.0 ? s : es;
+}
+
+inline double sigmoidFast(double z) {
+    double e = fastExpKernel(-std::fabs(z));
+    double s = 1.0 / (1.0 + e);
+    double es = e * s;
+    return z >= 0.0 ? s : es;
+}
+
+}  // namespace
+
+double fastExp(double x) {
+    return fastExpKernel(x);
+}
+
+double fastLog1p(double u) {
+    return fastLog1pKernel(u);
+}
+
+double softplus(double x, KernelMode mode) {
+    return mode == KernelMode::Fast ? softplusFast(x) : softplusExact(x);
+}
+
+double sigmoid(double z, KernelMode mode) {
+    return mode == KernelMode::Fast ? sigmoidFast(z) : sigmoidExact(z);
+}
+
+double logSigmoid(double z, KernelMode mode) {
+    return -softplus(-z, mode);
+}
+
+double logLossFromLogit(double z, double y, KernelMode mode) {
+    return softplus(z, mode) - y * z;
+}
+
+// The mode is checked once outside the loops so the fast loops stay branch-free
+void sigmoidBatch(const double* z, double* out, std::size_t n, KernelMode mode) {
+    if (mode == KernelMode::Fast) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = sigmoidFast(z[i]);
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = sigmoidExact(z[i]);
+        }
+    }
+}
+
+double logLossSum(const double* z, const double* y, std::size_t n, KernelMode mode) {
+    double sum = 0.0;
+    if (mode == KernelMode::Fast) {
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += softplusFast(z[i]) - y[i] * z[i];
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += softplusExact(z[i]) - y[i] * z[i];
+        }
+    }
+    return sum;
+}
+
+}  // namespace SigmoidKernels
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <tuple>
 #include <optional>  // For std::optional
+#include <vector>
 #include "Logger.h"
 
 class DatabaseOperations {
@@ -25,6 +26,10 @@ public:
     // Fetches a row from the database as a tuple (optional return)
     virtual std::optional<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>> fetch_row(int row_number);
 
+    // Fetches all rows with rowid greater than last_rowid in a single range query.
+    // On success last_rowid is advanced to the highest rowid returned; std::nullopt on a database error
+    virtual std::optional<std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>>> fetch_rows_since(sqlite3_int64& last_rowid);
+
     bool DatabaseOperations::verify_table_schema();
 
     // Destructor to close the database
@@ -2,14 +2,18 @@
 #define LOGISTICREGRESSION_H
 
 #include "DatabaseOperations.h"
+#include "SigmoidKernels.h"
 #include <vector>
 #include <tuple>
+#include <string>
 
 class LogisticRegression {
 private:
     std::vector<double> theta;
     double alpha;
     int iterations;
+    sqlite3_int64 last_rowid;  // High-water mark of rows already used for training
+    SigmoidKernels::KernelMode kernel_mode;  // Exact (libm) or fast approximated sigmoid/log-loss
 
     // Helper functions
     double sigmoid(double z);
@@ -18,10 +22,23 @@ private:
     int calculateErrors(const std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>>& test_data);
 
 public:
-    LogisticRegression(double alpha, int iterations);
+    LogisticRegression(double alpha, int iterations, SigmoidKernels::KernelMode kernel_mode = SigmoidKernels::KernelMode::Exact);
 
     void crossValidation(DatabaseOperations& db_ops, int k_folds);
-    void trainModel(DatabaseOperations& db_train, DatabaseOperations& db_test);
+    // Returns false if the training data could not be fetched
+    bool trainModel(DatabaseOperations& db_train, DatabaseOperations& db_test);
+
+    // Loads the model saved after trainModel, trains for a bounded number of epochs on rows
+    // appended since the last run only, and saves the updated model back.
+    // Returns false without training if the model is missing or malformed, or on a database error
+    bool trainIncremental(DatabaseOperations& db_train, const std::string& model_path, int epochs);
+
+    // Model persistence (weights and rowid high-water mark); saving replaces the file atomically
+    bool saveModel(const std::string& model_path) const;
+    bool loadModel(const std::string& model_path);
+
+    const std::vector<double>& getTheta() const;
+    sqlite3_int64 getLastRowId() const;
 };
 
 #endif // LOGISTICREGRESSION_H
@@ -0,0 +1,42 @@
+#ifndef SIGMOIDKERNELS_H
+#define SIGMOIDKERNELS_H
+
+#include <cstddef>
+
+// Numerically stable sigmoid and log-loss kernels.
+// Every function takes the logit z, so large |z| never overflows exp or
+// produces log(0). The Fast mode replaces libm exp/log with a branch-free
+// polynomial approximation that the compiler can vectorize across rows
+// (relative error of exp below 1e-13, absolute error of the loss below 1e-11).
+namespace SigmoidKernels {
+
+enum class KernelMode {
+    Exact,  // libm exp/log1p
+    Fast    // polynomial approximation
+};
+
+// Approximation of exp(x); inputs are clamped to [-708, 709]
+double fastExp(double x);
+
+// Approximation of log(1 + u) for u in [0, 1]
+double fastLog1p(double u);
+
+// softplus(x) = log(1 + exp(x))
+double softplus(double x, KernelMode mode = KernelMode::Exact);
+
+// 1 / (1 + exp(-z)) without overflow for any z
+double sigmoid(double z, KernelMode mode = KernelMode::Exact);
+
+// log(sigmoid(z)) = -softplus(-z)
+double logSigmoid(double z, KernelMode mode = KernelMode::Exact);
+
+// Cross-entropy loss -y*log(h) - (1-y)*log(1-h) computed from the logit: softplus(z) - y*z
+double logLossFromLogit(double z, double y, KernelMode mode = KernelMode::Exact);
+
+// Batch versions working on contiguous arrays of n logits
+void sigmoidBatch(const double* z, double* out, std::size_t n, KernelMode mode = KernelMode::Exact);
+double logLossSum(const double* z, const double* y, std::size_t n, KernelMode mode = KernelMode::Exact);
+
+}  // namespace SigmoidKernels
+
+#endif // SIGMOIDKERNELS_H
@@ -1,12 +1,15 @@
 #include "LogisticRegression.h"
 #include "DatabaseOperations.h"
 #include "Logger.h"
+#include <filesystem>  // std::filesystem::exists
 
 int main() {
     // Settings for gradient descent
     double alpha = 0.000001;
     int iterations = 1000000;
     int k_folds = 5;  // Number of folds for cross-validation
+    int incremental_epochs = 1000;  // Epochs over newly appended rows in incremental mode
+    std::string model_path = "database/model.txt";  // Persisted model for incremental training
     
     // Database initialization
     sqlite3* db1;
@@ -23,12 +26,28 @@ int main() {
     }
     
     LogisticRegression model(alpha, iterations);
-    
-    // Perform cross-validation on k folds
-    model.crossValidation(db_train, k_folds);
-    
-    // Train and test the model
-    model.trainModel(db_train, db_test);
+
+    if (std::filesystem::exists(model_path)) {
+        // Refresh the saved model with rows appended since the last run only
+        if (!model.trainIncremental(db_train, model_path, incremental_epochs)) {
+            std::cerr << "Error: Incremental training failed!" << std::endl;
+            return -1;
+        }
+    } else {
+        // Perform cross-validation on k folds
+        model.crossValidation(db_train, k_folds);
+
+        // Train and test the model, then save it as the base for incremental runs
+        if (!model.trainModel(db_train, db_test)) {
+            std::cerr << "Error: Training failed!" << std::endl;
+            return -1;
+        }
+        if (!model.saveModel(model_path)) {
+            Logger log("Failed to save the trained model to " + model_path);
+            std::cerr << "Error: Unable to save the model!" << std::endl;
+            return -1;
+        }
+    }
 
     return 0;
 }
@@ -48,3 +48,34 @@ TEST(DatabaseOperationsTest, MultipleDatabaseTest) {
         }
     }
 }
+
+// Test fetching rows appended after a given rowid
+TEST(DatabaseOperationsTest, FetchRowsSinceTest) {
+    sqlite3* db = nullptr;
+    DatabaseOperations dbOps("tests/test_db/valid_test.sqlite", &db);
+    ASSERT_TRUE(dbOps.open_database());
+
+    // All rows are returned from rowid 0 and the high-water mark moves to the last row
+    sqlite3_int64 last_rowid = 0;
+    auto rows = dbOps.fetch_rows_since(last_rowid).value();
+    ASSERT_FALSE(rows.empty());
+    EXPECT_EQ(last_rowid, static_cast<sqlite3_int64>(rows.size()));
+    EXPECT_EQ(rows.front(), dbOps.fetch_row(0).value());
+
+    // No rows after the high-water mark, which stays unchanged
+    sqlite3_int64 previous_rowid = last_rowid;
+    rows = dbOps.fetch_rows_since(last_rowid).value();
+    EXPECT_TRUE(rows.empty());
+    EXPECT_EQ(last_rowid, previous_rowid);
+
+    // Only rows after the given rowid are returned
+    last_rowid = previous_rowid - 1;
+    rows = dbOps.fetch_rows_since(last_rowid).value();
+    EXPECT_EQ(rows.size(), 1u);
+    EXPECT_EQ(last_rowid, previous_rowid);
+
+    // A failed query is reported as std::nullopt and leaves the high-water mark unchanged
+    dbOps.close_database();
+    EXPECT_FALSE(dbOps.fetch_rows_since(last_rowid).has_value());
+    EXPECT_EQ(last_rowid, previous_rowid);
+}
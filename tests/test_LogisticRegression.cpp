@@ -4,11 +4,15 @@
 #include <vector>
 #include <tuple>
 #include <cmath>
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <sstream>
+#include <filesystem>
 
 class MockDatabaseOperations : public DatabaseOperations {
 public:
     MockDatabaseOperations(const std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>>& rows)
-        : DatabaseOperations("", nullptr), rows(rows), current_row(0) {}
+        : DatabaseOperations("", nullptr), rows(rows), current_row(0), fail_queries(false) {}
 
     std::optional<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>> fetch_row(int row_number) override {
         if (row_number >= 0 && row_number < rows.size()) {
@@ -17,13 +21,38 @@ public:
         return std::nullopt;
     }
 
+    // Rows are numbered from rowid 1, like in SQLite
+    std::optional<std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>>> fetch_rows_since(sqlite3_int64& last_rowid) override {
+        if (fail_queries) {
+            return std::nullopt;
+        }
+        std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>> result;
+        for (sqlite3_int64 i = last_rowid; i < static_cast<sqlite3_int64>(rows.size()); ++i) {
+            result.push_back(rows[i]);
+        }
+        if (!result.empty()) {
+            last_rowid = rows.size();
+        }
+        return result;
+    }
+
+    void append(const std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>& row) {
+        rows.push_back(row);
+    }
+
     void reset() {
         current_row = 0;
     }
 
+    // Simulates a database error in fetch_rows_since
+    void set_fail_queries(bool fail) {
+        fail_queries = fail;
+    }
+
 private:
     std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>> rows;
     int current_row;
+    bool fail_queries;
 };
 
 // Testing the `trainModel` function
@@ -47,7 +76,10 @@ TEST(LogisticRegressionTest, TrainModelTest) {
     LogisticRegression model(0.01, 1000);
 
     // Training the model
-    model.trainModel(db_train, db_test);
+    EXPECT_TRUE(model.trainModel(db_train, db_test));
+
+    // Full training sets the high-water mark used by incremental runs
+    EXPECT_EQ(model.getLastRowId(), 2);
 }
 
 // Testing the `crossValidation` function
@@ -69,3 +101,126 @@ TEST(LogisticRegressionTest, CrossValidationTest) {
     // Cross-validation
     model.crossValidation(db_ops, 2); // k=2 folds
 }
+
+// Testing the `trainIncremental` function
+TEST(LogisticRegressionTest, TrainIncrementalTest) {
+    std::string model_path = "tests/test_db/model_test.txt";
+    std::remove(model_path.c_str());
+
+    std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>> data = {
+        {45, 1, 3, 120, 240, 0, 1, 150, 0, 2.0, 1, 0, 2, 1}, // expected target = 1
+        {34, 0, 2, 130, 220, 1, 0, 140, 1, 1.5, 0, 1, 1, 0}, // expected target = 0
+    };
+    MockDatabaseOperations db_train(data);
+
+    // Without a saved model incremental training fails and creates no file
+    LogisticRegression no_model(0.0001, 10);
+    EXPECT_FALSE(no_model.trainIncremental(db_train, model_path, 10));
+    EXPECT_FALSE(std::filesystem::exists(model_path));
+
+    // First run: full training, saved as the base for incremental runs
+    LogisticRegression first_run(0.0001, 10);
+    ASSERT_TRUE(first_run.trainModel(db_train, db_train));
+    ASSERT_TRUE(first_run.saveModel(model_path));
+    EXPECT_EQ(first_run.getLastRowId(), 2);
+    EXPECT_FALSE(std::filesystem::exists(model_path + ".tmp"));
+
+    // Second run without new rows: the saved model is loaded and left unchanged
+    LogisticRegression second_run(0.0001, 10);
+    EXPECT_TRUE(second_run.trainIncremental(db_train, model_path, 10));
+    EXPECT_EQ(second_run.getLastRowId(), 2);
+    EXPECT_EQ(second_run.getTheta(), first_run.getTheta());
+
+    // A database error is reported and the saved model is kept
+    db_train.append({50, 1, 4, 135, 250, 1, 1, 160, 0, 3.0, 1, 0, 2, 1});
+    db_train.set_fail_queries(true);
+    LogisticRegression failed_run(0.0001, 10);
+    EXPECT_FALSE(failed_run.trainIncremental(db_train, model_path, 10));
+    LogisticRegression unchanged(0.0001, 10);
+    ASSERT_TRUE(unchanged.loadModel(model_path));
+    EXPECT_EQ(unchanged.getLastRowId(), 2);
+    db_train.set_fail_queries(false);
+
+    // Third run: only the appended row is used, starting from the saved weights
+    LogisticRegression third_run(0.0001, 10);
+    EXPECT_TRUE(third_run.trainIncremental(db_train, model_path, 10));
+    EXPECT_EQ(third_run.getLastRowId(), 3);
+    EXPECT_NE(third_run.getTheta(), first_run.getTheta());
+
+    LogisticRegression reloaded(0.0001, 10);
+    ASSERT_TRUE(reloaded.loadModel(model_path));
+    EXPECT_EQ(reloaded.getLastRowId(), 3);
+    EXPECT_EQ(reloaded.getTheta(), third_run.getTheta());
+
+    std::remove(model_path.c_str());
+}
+
+// Testing that a malformed model file is rejected and never overwritten
+TEST(LogisticRegressionTest, MalformedModelTest) {
+    std::string model_path = "tests/test_db/model_malformed_test.txt";
+    std::vector<std::tuple<int, int, int, int, int, int, int, int, int, double, int, int, int, int>> data = {
+        {45, 1, 3, 120, 240, 0, 1, 150, 0, 2.0, 1, 0, 2, 1}, // expected target = 1
+    };
+    MockDatabaseOperations db_train(data);
+
+    std::string last_rowid = "5\n";
+    std::string coefficients;
+    for (int i = 0; i < 13; ++i) {
+        coefficients += "0.5\n";
+    }
+
+    std::vector<std::string> malformed_contents = {
+        last_rowid + "0.5\n0.5\n",                  // Truncated
+        last_rowid + coefficients + "0.5\n",         // Extra coefficient
+        last_rowid + coefficients + "garbage\n",     // Trailing text
+    };
+
+    for (const auto& contents : malformed_contents) {
+        {
+            std::ofstream file(model_path, std::ios_base::trunc);
+            file << contents;
+        }
+
+        LogisticRegression model(0.0001, 10);
+        EXPECT_FALSE(model.loadModel(model_path));
+        EXPECT_EQ(model.getLastRowId(), 0);
+
+        // Incremental training stops and leaves the file untouched
+        EXPECT_FALSE(model.trainIncremental(db_train, model_path, 10));
+        EXPECT_EQ(model.getTheta(), std::vector<double>(13, 0.0));
+
+        std::ifstream file(model_path);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        EXPECT_EQ(buffer.str(), contents);
+    }
+
+    // The same file without the extra data loads correctly
+    {
+        std::ofstream file(model_path, std::ios_base::trunc);
+        file << last_rowid << coefficients;
+    }
+    LogisticRegression model(0.0001, 10);
+    EXPECT_TRUE(model.loadModel(model_path));
+    EXPECT_EQ(model.getLastRowId(), 5);
+    EXPECT_EQ(model.getTheta(), std::vector<double>(13, 0.5));
+
+    std::remove(model_path.c_str());
+}
+
+// Testing that a failed save keeps the existing file and leaves no temporary file
+TEST(LogisticRegressionTest, SaveModelFailureTest) {
+    // The rename fails because the target is a directory
+    std::string model_path = "tests/test_db/model_dir_test";
+    std::filesystem::create_directory(model_path);
+
+    LogisticRegression model(0.0001, 10);
+    EXPECT_FALSE(model.saveModel(model_path));
+    EXPECT_TRUE(std::filesystem::is_directory(model_path));
+    EXPECT_FALSE(std::filesystem::exists(model_path + ".tmp"));
+
+    // The temporary file cannot be created in a missing directory
+    EXPECT_FALSE(model.saveModel("tests/test_db/missing_dir/model.txt"));
+
+    std::filesystem::remove(model_path);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "SigmoidKernels.h"
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <string>
+
+using SigmoidKernels::KernelMode;
+
+// Testing the accuracy of the exp approximation against libm
+TEST(SigmoidKernelsTest, FastExpAccuracyTest) {
+    double max_relative_error = 0.0;
+    for (double x = -700.0; x <= 700.0; x += 0.0137) {
+        double exact = std::exp(x);
+        double relative_error = std::fabs(SigmoidKernels::fastExp(x) - exact) / exact;
+        max_relative_error = std::max(max_relative_error, relative_error);
+    }
+    EXPECT_LT(max_relative_error, 1e-13);
+
+    // Inputs outside the range are clamped instead of overflowing
+    EXPECT_TRUE(std::isfinite(SigmoidKernels::fastExp(1000.0)));
+    EXPECT_GE(SigmoidKernels::fastExp(-1000.0), 0.0);
+}
+
+// Testing the accuracy of the log1p approximation on [0, 1]
+TEST(SigmoidKernelsTest, FastLog1pAccuracyTest) {
+    for (double u = 0.0; u <= 1.0; u += 0.001) {
+        EXPECT_NEAR(SigmoidKernels::fastLog1p(u), std::log1p(u), 1e-11) << "u = " << u;
+    }
+}
+
+// Testing that sigmoid, log-sigmoid and log-loss stay finite for large |z| in both modes
+TEST(SigmoidKernelsTest, StabilityTest) {
+    for (KernelMode mode : {KernelMode::Exact, KernelMode::Fast}) {
+        EXPECT_DOUBLE_EQ(SigmoidKernels::sigmoid(1000.0, mode), 1.0);
+        EXPECT_GE(SigmoidKernels::sigmoid(-1000.0, mode), 0.0);
+        EXPECT_LT(SigmoidKernels::sigmoid(-1000.0, mode), 1e-300);
+        EXPECT_DOUBLE_EQ(SigmoidKernels::sigmoid(0.0, mode), 0.5);
+
+        EXPECT_NEAR(SigmoidKernels::logSigmoid(-1000.0, mode), -1000.0, 1e-9);
+        EXPECT_NEAR(SigmoidKernels::logSigmoid(1000.0, mode), 0.0, 1e-12);
+
+        // A confident wrong prediction costs |z| instead of inf
+        EXPECT_NEAR(SigmoidKernels::logLossFromLogit(1000.0, 0.0, mode), 1000.0, 1e-9);
+        EXPECT_NEAR(SigmoidKernels::logLossFromLogit(-1000.0, 1.0, mode), 1000.0, 1e-9);
+        EXPECT_NEAR(SigmoidKernels::logLossFromLogit(1000.0, 1.0, mode), 0.0, 1e-12);
+
+        // A NaN logit (e.g. from a NaN feature) stays NaN
+        double nan = std::nan("");
+        EXPECT_TRUE(std::isnan(SigmoidKernels::sigmoid(nan, mode)));
+        EXPECT_TRUE(std::isnan(SigmoidKernels::logSigmoid(nan, mode)));
+        EXPECT_TRUE(std::isnan(SigmoidKernels::logLossFromLogit(nan, 1.0, mode)));
+
+        double out = 0.0;
+        SigmoidKernels::sigmoidBatch(&nan, &out, 1, mode);
+        EXPECT_TRUE(std::isnan(out));
+    }
+    EXPECT_TRUE(std::isnan(SigmoidKernels::fastExp(std::nan(""))));
+}
+
+// Testing the fast mode against the exact one and the naive formulas
+TEST(SigmoidKernelsTest, FastMatchesExactTest) {
+    for (double z = -30.0; z <= 30.0; z += 0.01) {
+        double h = 1.0 / (1.0 + std::exp(-z));
+        EXPECT_NEAR(SigmoidKernels::sigmoid(z, KernelMode::Exact), h, 1e-15);
+        EXPECT_NEAR(SigmoidKernels::sigmoid(z, KernelMode::Fast), h, 1e-14);
+
+        for (double y : {0.0, 1.0}) {
+            double exact = SigmoidKernels::logLossFromLogit(z, y, KernelMode::Exact);
+            double fast = SigmoidKernels::logLossFromLogit(z, y, KernelMode::Fast);
+            EXPECT_NEAR(fast, exact, 1e-11);
+            if (std::fabs(z) < 10.0) {
+                EXPECT_NEAR(exact, -y * std::log(h) - (1 - y) * std::log(1 - h), 1e-9);
+            }
+        }
+    }
+}
+
+// Testing the batch kernels against the scalar functions in both modes
+TEST(SigmoidKernelsTest, BatchMatchesScalarTest) {
+    const size_t n = 1 << 16;
+    std::vector<double> z(n), y(n), out_exact(n), out_fast(n);
+    for (size_t i = 0; i < n; ++i) {
+        z[i] = -40.0 + 80.0 * static_cast<double>(i) / n;
+        y[i] = i % 2;
+    }
+
+    SigmoidKernels::sigmoidBatch(z.data(), out_exact.data(), n, KernelMode::Exact);
+    SigmoidKernels::sigmoidBatch(z.data(), out_fast.data(), n, KernelMode::Fast);
+
+    double loss_exact = 0.0;
+    double loss_fast = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_DOUBLE_EQ(out_exact[i], SigmoidKernels::sigmoid(z[i], KernelMode::Exact));
+        EXPECT_DOUBLE_EQ(out_fast[i], SigmoidKernels::sigmoid(z[i], KernelMode::Fast));
+        EXPECT_NEAR(out_fast[i], out_exact[i], 1e-14);
+        loss_exact += SigmoidKernels::logLossFromLogit(z[i], y[i], KernelMode::Exact);
+        loss_fast += SigmoidKernels::logLossFromLogit(z[i], y[i], KernelMode::Fast);
+    }
+    EXPECT_NEAR(SigmoidKernels::logLossSum(z.data(), y.data(), n, KernelMode::Exact), loss_exact, 1e-9);
+    EXPECT_NEAR(SigmoidKernels::logLossSum(z.data(), y.data(), n, KernelMode::Fast), loss_fast, 1e-9);
+}
+
+// Best of several runs of the batch sigmoid and log-loss over n logits, in milliseconds
+double timeBatchKernels(const std::vector<double>& z, const std::vector<double>& y, std::vector<double>& out, KernelMode mode) {
+    double best_ms = 0.0;
+    for (int run = 0; run < 5; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        SigmoidKernels::sigmoidBatch(z.data(), out.data(), z.size(), mode);
+        out[0] += SigmoidKernels::logLossSum(z.data(), y.data(), z.size(), mode);
+        auto end = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (run == 0 || ms < best_ms) {
+            best_ms = ms;
+        }
+    }
+    return best_ms;
+}
+
+// Testing that the fast kernels are not slower than the exact ones
+TEST(SigmoidKernelsTest, BatchThroughputTest) {
+#if !(defined(NATIVE_SIGMOID_KERNELS) && defined(NDEBUG))
+    GTEST_SKIP() << "Throughput is only checked in optimized builds with NATIVE_SIGMOID_KERNELS";
+#endif
+
+    const size_t n = 1 << 20;
+    std::vector<double> z(n), y(n), out(n);
+    for (size_t i = 0; i < n; ++i) {
+        z[i] = -40.0 + 80.0 * static_cast<double>(i) / n;
+        y[i] = i % 2;
+    }
+
+    double exact_ms = timeBatchKernels(z, y, out, KernelMode::Exact);
+    double fast_ms = timeBatchKernels(z, y, out, KernelMode::Fast);
+    RecordProperty("exact_ms", std::to_string(exact_ms));
+    RecordProperty("fast_ms", std::to_string(fast_ms));
+
+    // The vectorized fast path is several times faster, so this leaves ample room for timing noise
+    EXPECT_LT(fast_ms, exact_ms) << "Exact: " << exact_ms << " ms, fast: " << fast_ms << " ms";
+}